@@ -1,19 +1,5 @@
 #include "NodeLib_ESP32_ANCS.h"
-#include "esp_mac.h"
-#include "esp_gap_ble_api.h"
-
-// --- UUID CONSTANTS ---
-static BLEUUID ANCS_SERVICE_UUID("7905F431-B5CE-4E99-A40F-4B1E122D00D0");
-static BLEUUID ANCS_NOTIF_UUID("9FBF120D-6301-42D9-8C58-25E699A21DBD");
-static BLEUUID ANCS_CP_UUID("69D1D8F3-45E1-49A8-9821-9BBDFDAAD9D9");
-static BLEUUID ANCS_DATA_UUID("22EAC6E9-24D6-4BB5-BE44-B36ACE7C7FDB");
-// Fallback for non-standard or corrupted UUIDs seen in logs
-static BLEUUID ANCS_DATA_UUID_ALT("22eac6e9-24d6-4bb5-be44-b36ace7c7bfb");
-
-static BLEUUID AMS_SERVICE_UUID("89D3502B-0F36-433A-8EF4-C502AD55F8DC");
-static BLEUUID AMS_REMOTE_CMD_UUID("9B3C81D8-57B1-4A8A-B8DF-0E56F7CA51C2");
-static BLEUUID AMS_ENTITY_UPDATE_UUID("2F7CABCE-808D-411F-9A0C-BB92BA96C102");
-static BLEUUID AMS_ENTITY_ATTR_UUID("C6B2F38C-23AB-46D8-A6AB-A3A870BBD5D7");
+#include <stdlib.h>
 
 // ANCS Commands
 #define CP_CMD_GET_NOTIF_ATTRS 0
@@ -38,55 +24,21 @@ static BLEUUID AMS_ENTITY_ATTR_UUID("C6B2F38C-23AB-46D8-A6AB-A3A870BBD5D7");
 #define AMSTrackAttr_Album  1
 #define AMSTrackAttr_Title  2
 
-NodeLib_ESP32_ANCS* globalNodeLibInstance = nullptr;
-
-// --- SECURITY CALLBACKS ---
-class NodeLibSecurityCallbacks : public BLESecurityCallbacks {
-  uint32_t onPassKeyRequest(){ return 0; }
-  void onPassKeyNotify(uint32_t pass_key){ Serial.printf(">> [PAIRING] PIN: %06d\n", pass_key); }
-  bool onConfirmPIN(uint32_t pass_key){ return true; } 
-  bool onSecurityRequest(){ return true; }
-  void onAuthenticationComplete(esp_ble_auth_cmpl_t cmpl){
-    if(cmpl.success){
-        Serial.println(">> [PAIRING] Success!");
-    } else {
-        Serial.printf(">> [PAIRING] Fail: %d\n", cmpl.fail_reason);
-    }
-    if(globalNodeLibInstance) globalNodeLibInstance->_onSecurityComplete(cmpl.success);
-  }
-};
-
-// --- SERVER CALLBACKS ---
-class NodeLibServerCallbacks : public BLEServerCallbacks {
-  void onConnect(BLEServer* pServer, esp_ble_gatts_cb_param_t *param) {
-    if (globalNodeLibInstance) globalNodeLibInstance->_handleConnect(param);
-  }
-  void onDisconnect(BLEServer* pServer) {
-    if (globalNodeLibInstance) globalNodeLibInstance->_handleDisconnect();
-  }
-};
-
-// --- STATIC WRAPPERS ---
-static void staticOnAncsData(BLERemoteCharacteristic* pChar, uint8_t* pData, size_t length, bool isNotify) {
-    if (globalNodeLibInstance) globalNodeLibInstance->_onAncsDataReceived(pData, length);
-}
-static void staticOnAncsNotif(BLERemoteCharacteristic* pChar, uint8_t* pData, size_t length, bool isNotify) {
-    if (globalNodeLibInstance) globalNodeLibInstance->_onAncsNotificationReceived(pData, length);
-}
-static void staticOnAmsUpdate(BLERemoteCharacteristic* pChar, uint8_t* pData, size_t length, bool isNotify) {
-    if (globalNodeLibInstance) globalNodeLibInstance->_onAmsUpdateReceived(pData, length);
-}
+#ifndef ARDUINO
+unsigned long nodelib_host_millis = 0;
+#endif
 
 // --- IMPLEMENTATION ---
 
-NodeLib_ESP32_ANCS::NodeLib_ESP32_ANCS() {
-    globalNodeLibInstance = this;
+NodeLib_ESP32_ANCS::NodeLib_ESP32_ANCS(NodeLibTransport& transport) {
+    _transport = &transport;
+    _transport->setListener(this);
     _currentState = STATE_ADVERTISING;
     _pState = ST_WAIT_CMD;
     _cbNotify = nullptr;
     _cbMedia = nullptr;
-    _pRemoteAddress = nullptr;
-    _pClient = nullptr;
+    _pendingRequest = false;
+    _securityDone = false;
     
     _amsAvailable = false;
     _ancsAvailable = false;
@@ -104,65 +56,17 @@ void NodeLib_ESP32_ANCS::setMediaCallback(NodeLibMediaCallback cb) { _cbMedia =
 
 void NodeLib_ESP32_ANCS::setState(AppState newState) {
     _currentState = newState;
-    _stateStartTime = millis();
-    Serial.printf(">> [STATE] -> %d\n", newState);
+    _stateStartTime = nodelib_millis();
+    NODELIB_LOG(">> [STATE] -> %d\n", newState);
 }
 
 void NodeLib_ESP32_ANCS::_onSecurityComplete(bool success) { _securityDone = success; }
 
-void NodeLib_ESP32_ANCS::addSolicitation(BLEAdvertisementData &adv, BLEUUID uuid) {
-    uint8_t d[18];
-    d[0] = 17; d[1] = 0x15; // Len, Type
-    
-    esp_bt_uuid_t *raw = uuid.getNative();
-    for(int i=0; i<16; i++) {
-        d[2+i] = raw->uuid.uuid128[15-i]; 
-    }
-    String s = "";
-    for(int i=0; i<18; i++) s += (char)d[i];
-    adv.addData(s);
-}
-
 void NodeLib_ESP32_ANCS::begin(const char* deviceName) {
-    BLEDevice::init(deviceName); 
-    BLEDevice::setMTU(517);
-    
-    BLEDevice::setEncryptionLevel(ESP_BLE_SEC_ENCRYPT_MITM);
-    BLEDevice::setSecurityCallbacks(new NodeLibSecurityCallbacks());
-  
-    _pServer = BLEDevice::createServer();
-    _pServer->setCallbacks(new NodeLibServerCallbacks()); 
-  
-    // Device Info & HID
-    _pServer->createService(BLEUUID("180A"))->start();
-    _pServer->createService(BLEUUID((uint16_t)0x1812))->start();
-  
-    BLEAdvertising *pAdv = BLEDevice::getAdvertising();
-    
-    BLEAdvertisementData oAdvData;
-    oAdvData.setFlags(0x06); 
-    oAdvData.setName(deviceName);
-    oAdvData.setAppearance(0x00C2); 
-    oAdvData.setCompleteServices(BLEUUID((uint16_t)0x1812)); 
-    pAdv->setAdvertisementData(oAdvData);
-  
-    BLEAdvertisementData oScanData;
-    addSolicitation(oScanData, ANCS_SERVICE_UUID);
-    pAdv->setScanResponseData(oScanData);
-    pAdv->setScanResponse(true);
-    
-    BLESecurity *pSec = new BLESecurity();
-    pSec->setAuthenticationMode(ESP_LE_AUTH_REQ_SC_MITM_BOND);
-    pSec->setCapability(ESP_IO_CAP_IO); 
-    pSec->setInitEncryptionKey(ESP_BLE_ENC_KEY_MASK | ESP_BLE_ID_KEY_MASK);
-  
-    BLEDevice::startAdvertising();
+    _transport->begin(deviceName);
 }
 
-void NodeLib_ESP32_ANCS::_handleConnect(esp_ble_gatts_cb_param_t *param) {
-    if (_pRemoteAddress) delete _pRemoteAddress;
-    _pRemoteAddress = new BLEAddress(param->connect.remote_bda);
-    Serial.printf(">> [CONN] %s\n", _pRemoteAddress->toString().c_str());
+void NodeLib_ESP32_ANCS::_handleConnect() {
     _securityDone = false;
     _servicesDumped = false;
     _ancsCharsDumped = false;
@@ -170,72 +74,23 @@ void NodeLib_ESP32_ANCS::_handleConnect(esp_ble_gatts_cb_param_t *param) {
 }
 
 void NodeLib_ESP32_ANCS::_handleDisconnect() {
-    Serial.println(">> [DISC] Disconnected");
+    NODELIB_LOG(">> [DISC] Disconnected\n");
     _securityDone = false;
     _amsAvailable = false;
     _ancsAvailable = false;
     _servicesDumped = false;
     _ancsCharsDumped = false;
     setState(STATE_ADVERTISING);
-    BLEDevice::startAdvertising();
-}
-
-// FIX: Case-insensitive service lookup
-BLERemoteService* NodeLib_ESP32_ANCS::findService(BLEUUID uuid) {
-    BLERemoteService* pS = _pClient->getService(uuid);
-    if (pS) return pS;
-
-    std::map<std::string, BLERemoteService*>* pServices = _pClient->getServices();
-    if (!pServices) return nullptr;
-    
-    for (auto const& [uuid_str, service] : *pServices) {
-        if (service->getUUID().equals(uuid)) {
-            return service;
-        }
-    }
-    return nullptr;
-}
-
-void NodeLib_ESP32_ANCS::dumpVisibleServices() {
-    if(!_pClient) return;
-    std::map<std::string, BLERemoteService*>* pServices = _pClient->getServices();
-    if (pServices == nullptr) {
-        Serial.println(">> [DEBUG] getServices() returned null!");
-        return;
-    }
-    
-    Serial.println(">> [DEBUG] --- Remote Service Dump ---");
-    for (auto const& [uuid_str, service] : *pServices) {
-        Serial.printf("   - UUID: %s\n", service->getUUID().toString().c_str());
-        if (service->getUUID().equals(ANCS_SERVICE_UUID)) Serial.println("     ^-- THIS IS ANCS!");
-    }
-    Serial.println(">> [DEBUG] ---------------------------");
-}
-
-void NodeLib_ESP32_ANCS::dumpServiceCharacteristics(BLERemoteService* pService) {
-    if (!pService) return;
-    std::map<std::string, BLERemoteCharacteristic*>* pChars = pService->getCharacteristics();
-    if (!pChars) {
-        Serial.println(">> [DEBUG] Service has NO characteristics map.");
-        return;
-    }
-    Serial.printf(">> [DEBUG] Dump Chars for Service: %s\n", pService->getUUID().toString().c_str());
-    for (auto const& [uuid_str, pChar] : *pChars) {
-         Serial.printf("   - Char UUID: %s\n", pChar->getUUID().toString().c_str());
-    }
-    Serial.println(">> [DEBUG] ---------------------------");
+    _transport->startAdvertising();
 }
 
-BLERemoteCharacteristic* NodeLib_ESP32_ANCS::findChar(BLERemoteService* pService, BLEUUID uuid) {
-    if (!pService) return nullptr;
-    BLERemoteCharacteristic* pChar = pService->getCharacteristic(uuid);
-    if (pChar) return pChar;
-    auto* m = pService->getCharacteristics();
-    if (!m) return nullptr;
-    for (auto& entry : *m) {
-        if (entry.second->getUUID().equals(uuid)) return entry.second;
+void NodeLib_ESP32_ANCS::_onCharNotify(NodeLibChar chr, uint8_t* pData, size_t length) {
+    switch (chr) {
+        case NODELIB_CHR_ANCS_DATA: _onAncsDataReceived(pData, length); break;
+        case NODELIB_CHR_ANCS_NOTIF: _onAncsNotificationReceived(pData, length); break;
+        case NODELIB_CHR_AMS_ENTITY_UPDATE: _onAmsUpdateReceived(pData, length); break;
+        default: break;
     }
-    return nullptr;
 }
 
 void NodeLib_ESP32_ANCS::loop() {
@@ -243,7 +98,7 @@ void NodeLib_ESP32_ANCS::loop() {
       if (_pendingRequest) {
           _pendingRequest = false; 
           performAncsRequest(_targetUID); 
-          delay(50); 
+          nodelib_delay(50); 
       }
   }
 
@@ -251,20 +106,15 @@ void NodeLib_ESP32_ANCS::loop() {
     case STATE_ADVERTISING: break;
         
     case STATE_CONNECTED_WAITING:
-      if (millis() - _stateStartTime > 2000) setState(STATE_CONNECTING_CLIENT);
+      if (nodelib_millis() - _stateStartTime > 2000) setState(STATE_CONNECTING_CLIENT);
       break;
       
     case STATE_CONNECTING_CLIENT:
-       if (!_pClient) _pClient = BLEDevice::createClient();
-       if (!_pClient->isConnected()) {
-           if (_pRemoteAddress) {
-               Serial.println(">> [CLIENT] Connecting to phone...");
-               if (_pClient->connect(*_pRemoteAddress)) {
-                   Serial.println(">> [CLIENT] Connected. Negotiating Security...");
-                   esp_bd_addr_t remoteAddr; memcpy(remoteAddr, _pRemoteAddress->getNative(), 6);
-                   esp_ble_set_encryption(remoteAddr, ESP_BLE_SEC_ENCRYPT_MITM);
-                   setState(STATE_WAIT_FOR_SECURITY); 
-               }
+       if (!_transport->isClientConnected()) {
+           NODELIB_LOG(">> [CLIENT] Connecting to phone...\n");
+           if (_transport->connectClient()) {
+               NODELIB_LOG(">> [CLIENT] Connected. Negotiating Security...\n");
+               setState(STATE_WAIT_FOR_SECURITY); 
            }
        } else {
            setState(STATE_WAIT_FOR_SECURITY);
@@ -273,64 +123,55 @@ void NodeLib_ESP32_ANCS::loop() {
 
     case STATE_WAIT_FOR_SECURITY:
        if (_securityDone) {
-           Serial.println(">> [SECURE] Encrypted. Looking for Services...");
+           NODELIB_LOG(">> [SECURE] Encrypted. Looking for Services...\n");
            setState(STATE_DISCOVERING_SERVICES);
-       } else if (millis() - _stateStartTime > 15000) {
-           Serial.println(">> [SECURE] Warning: Timeout waiting for security callback. Continuing anyway...");
+       } else if (nodelib_millis() - _stateStartTime > 15000) {
+           NODELIB_LOG(">> [SECURE] Warning: Timeout waiting for security callback. Continuing anyway...\n");
            setState(STATE_DISCOVERING_SERVICES);
        }
        break;
        
     case STATE_DISCOVERING_SERVICES:
        {
-           if (!_pClient->isConnected()) return;
+           if (!_transport->isClientConnected()) return;
 
            if (!_servicesDumped) {
-               dumpVisibleServices();
+               _transport->dumpServices();
                _servicesDumped = true;
            }
            
-           // ANCS Discovery (Enhanced with manual fallback)
+           // ANCS Discovery
            if (!_ancsAvailable) {
-               BLERemoteService* pAncs = findService(ANCS_SERVICE_UUID);
-               if (pAncs) {
-                    _pRemoteNotif = findChar(pAncs, ANCS_NOTIF_UUID);
-                    _pRemoteCP    = findChar(pAncs, ANCS_CP_UUID);
-                    _pRemoteData  = findChar(pAncs, ANCS_DATA_UUID);
-                    
-                    // Fallback for weird data UUID
-                    if (!_pRemoteData) {
-                       _pRemoteData = findChar(pAncs, ANCS_DATA_UUID_ALT);
-                       if (_pRemoteData) Serial.println(">> [ANCS] Found Data Source with ALT UUID.");
-                    }
+               if (_transport->discoverService(NODELIB_SVC_ANCS)) {
+                    bool hasNotif = _transport->hasChar(NODELIB_CHR_ANCS_NOTIF);
+                    bool hasCP    = _transport->hasChar(NODELIB_CHR_ANCS_CP);
+                    bool hasData  = _transport->hasChar(NODELIB_CHR_ANCS_DATA);
                     
-                    if (!_pRemoteNotif || !_pRemoteCP || !_pRemoteData) {
+                    if (!hasNotif || !hasCP || !hasData) {
                          if (!_ancsCharsDumped) {
-                             if (!_pRemoteNotif) Serial.println(">> [ERR] ANCS Notification Char missing");
-                             if (!_pRemoteCP) Serial.println(">> [ERR] ANCS Control Point Char missing");
-                             if (!_pRemoteData) Serial.println(">> [ERR] ANCS Data Source Char missing");
+                             if (!hasNotif) NODELIB_LOG(">> [ERR] ANCS Notification Char missing\n");
+                             if (!hasCP) NODELIB_LOG(">> [ERR] ANCS Control Point Char missing\n");
+                             if (!hasData) NODELIB_LOG(">> [ERR] ANCS Data Source Char missing\n");
                              
-                             Serial.println(">> [DEBUG] Dumping ALL characteristics found in ANCS Service:");
-                             dumpServiceCharacteristics(pAncs);
+                             NODELIB_LOG(">> [DEBUG] Dumping ALL characteristics found in ANCS Service:\n");
+                             _transport->dumpCharacteristics(NODELIB_SVC_ANCS);
                              _ancsCharsDumped = true;
                          }
                     } else {
-                         Serial.println(">> [ANCS] Service FOUND! (Notifications Enabled)");
+                         NODELIB_LOG(">> [ANCS] Service FOUND! (Notifications Enabled)\n");
                          _ancsAvailable = true;
                     }
                }
            }
 
-           // AMS Discovery (Enhanced with manual fallback)
+           // AMS Discovery
            if (!_amsAvailable) {
-               BLERemoteService* pAms = findService(AMS_SERVICE_UUID);
-               if (pAms) {
-                   _pRemoteCmd = findChar(pAms, AMS_REMOTE_CMD_UUID);
-                   _pRemoteEntityUpdate = findChar(pAms, AMS_ENTITY_UPDATE_UUID);
-                   _pRemoteEntityAttr = findChar(pAms, AMS_ENTITY_ATTR_UUID);
-                   if (_pRemoteCmd && _pRemoteEntityUpdate && _pRemoteEntityAttr) {
+               if (_transport->discoverService(NODELIB_SVC_AMS)) {
+                   if (_transport->hasChar(NODELIB_CHR_AMS_REMOTE_CMD) &&
+                       _transport->hasChar(NODELIB_CHR_AMS_ENTITY_UPDATE) &&
+                       _transport->hasChar(NODELIB_CHR_AMS_ENTITY_ATTR)) {
                        _amsAvailable = true;
-                       Serial.println(">> [AMS] Service FOUND! (Media Enabled)");
+                       NODELIB_LOG(">> [AMS] Service FOUND! (Media Enabled)\n");
                    }
                } 
            }
@@ -343,14 +184,14 @@ void NodeLib_ESP32_ANCS::loop() {
            } else if (_ancsAvailable && !_amsAvailable) {
                readyToSubscribe = true; 
            } else if (!_ancsAvailable && _amsAvailable) {
-               if (millis() - _stateStartTime > 8000) {
+               if (nodelib_millis() - _stateStartTime > 8000) {
                    static bool warned = false;
-                   if(!warned) { Serial.println(">> [WARN] ANCS Service STILL NOT found after retry. Continuing with partial features."); warned=true; }
+                   if(!warned) { NODELIB_LOG(">> [WARN] ANCS Service STILL NOT found after retry. Continuing with partial features.\n"); warned=true; }
                    readyToSubscribe = true; 
                }
            } else {
-               if (millis() - _stateStartTime > 15000) {
-                   Serial.println(">> [ERR] No Services found. Disconnecting.");
+               if (nodelib_millis() - _stateStartTime > 15000) {
+                   NODELIB_LOG(">> [ERR] No Services found. Disconnecting.\n");
                    _handleDisconnect();
                }
            }
@@ -362,33 +203,32 @@ void NodeLib_ESP32_ANCS::loop() {
        break;
        
     case STATE_SUBSCRIBING:
-       Serial.println(">> [SUB] Subscribing to characteristics...");
+       NODELIB_LOG(">> [SUB] Subscribing to characteristics...\n");
        // ANCS
-       if(_ancsAvailable && _pRemoteData && _pRemoteData->canNotify()) _pRemoteData->registerForNotify(staticOnAncsData);
-       if(_ancsAvailable && _pRemoteNotif && _pRemoteNotif->canNotify()) _pRemoteNotif->registerForNotify(staticOnAncsNotif);
+       if(_ancsAvailable) _transport->subscribe(NODELIB_CHR_ANCS_DATA);
+       if(_ancsAvailable) _transport->subscribe(NODELIB_CHR_ANCS_NOTIF);
        
        // AMS
-       if (_amsAvailable && _pRemoteEntityUpdate && _pRemoteEntityUpdate->canNotify()) {
-           _pRemoteEntityUpdate->registerForNotify(staticOnAmsUpdate);
+       if (_amsAvailable && _transport->subscribe(NODELIB_CHR_AMS_ENTITY_UPDATE)) {
            subscribeToAms();
        }
        
-       Serial.println(">> [READY] Listening for Events.");
+       NODELIB_LOG(">> [READY] Listening for Events.\n");
        setState(STATE_RUNNING);
        break;
        
     case STATE_RUNNING: break;
   }
-  delay(10);
+  nodelib_delay(10);
 }
 
 // --- ANCS ---
 
 void NodeLib_ESP32_ANCS::performAncsRequest(uint32_t uid) {
-    if(!_pRemoteCP) return;
+    if(!_transport->hasChar(NODELIB_CHR_ANCS_CP)) return;
     
     // Debug print
-    Serial.printf(">> [ANCS] Requesting details for UID: %d\n", uid);
+    NODELIB_LOG(">> [ANCS] Requesting details for UID: %d\n", uid);
 
     _activeRequestUID = uid;
     _pState = ST_WAIT_CMD; 
@@ -403,17 +243,16 @@ void NodeLib_ESP32_ANCS::performAncsRequest(uint32_t uid) {
     command[8] = ATTR_ID_TITLE; command[9] = 255; command[10] = 0;
     command[11] = ATTR_ID_MESSAGE; command[12] = 255; command[13] = 0;
 
-    _pRemoteCP->writeValue(command, 14, true); 
+    _transport->write(NODELIB_CHR_ANCS_CP, command, 14, true); 
 }
 
 void NodeLib_ESP32_ANCS::_onAncsNotificationReceived(uint8_t* pData, size_t length) {
     if (length < 8) return;
     uint8_t eventID = pData[0];
-    uint8_t eventFlags = pData[1];
     uint8_t catID = pData[2];
     uint32_t uid = (uint32_t)pData[4] | ((uint32_t)pData[5] << 8) | ((uint32_t)pData[6] << 16) | ((uint32_t)pData[7] << 24);
     
-    Serial.printf(">> [ANCS EVENT] ID:%d Cat:%d UID:%d\n", eventID, catID, uid);
+    NODELIB_LOG(">> [ANCS EVENT] ID:%d Cat:%d UID:%d\n", eventID, catID, uid);
 
     // EventID: 0=Added, 1=Modified, 2=Removed
     if (eventID == 0 || eventID == 1) { 
@@ -423,7 +262,7 @@ void NodeLib_ESP32_ANCS::_onAncsNotificationReceived(uint8_t* pData, size_t leng
 }
 
 void NodeLib_ESP32_ANCS::_onAncsDataReceived(uint8_t* pData, size_t length) {
-    for (int i = 0; i < length; i++) {
+    for (size_t i = 0; i < length; i++) {
         uint8_t b = pData[i];
         switch (_pState) {
             case ST_WAIT_CMD: 
@@ -488,19 +327,19 @@ void NodeLib_ESP32_ANCS::_onAncsDataReceived(uint8_t* pData, size_t length) {
 // --- AMS ---
 
 void NodeLib_ESP32_ANCS::subscribeToAms() {
-    if(!_pRemoteEntityUpdate || !_pRemoteEntityAttr) return;
+    if(!_transport->hasChar(NODELIB_CHR_AMS_ENTITY_UPDATE) || !_transport->hasChar(NODELIB_CHR_AMS_ENTITY_ATTR)) return;
     
     uint8_t cmdPlayer[] = { AMSID_Player, AMSPlayerAttr_PlaybackInfo }; 
-    _pRemoteEntityUpdate->writeValue(cmdPlayer, 2, true);
+    _transport->write(NODELIB_CHR_AMS_ENTITY_UPDATE, cmdPlayer, 2, true);
     
-    delay(500); 
+    nodelib_delay(500); 
     
     uint8_t cmdTrack[] = { 
         AMSID_Track, AMSTrackAttr_Artist, 
         AMSID_Track, AMSTrackAttr_Album, 
         AMSID_Track, AMSTrackAttr_Title 
     }; 
-    _pRemoteEntityUpdate->writeValue(cmdTrack, 6, true);
+    _transport->write(NODELIB_CHR_AMS_ENTITY_UPDATE, cmdTrack, 6, true);
 }
 
 void NodeLib_ESP32_ANCS::_onAmsUpdateReceived(uint8_t* pData, size_t length) {
@@ -510,20 +349,16 @@ void NodeLib_ESP32_ANCS::_onAmsUpdateReceived(uint8_t* pData, size_t length) {
     uint8_t attrID = pData[1];
     uint8_t flags = pData[2]; 
     
-    String valueStr = "";
-    if (length > 3) {
-        for(size_t i=3; i<length; i++) valueStr += (char)pData[i];
-    }
+    std::string valueStr = "";
+    if (length > 3) valueStr.assign((const char*)pData + 3, length - 3);
     if(flags & 1) valueStr += " (trunc)";
 
     bool isTimeUpdate = (entityID == AMSID_Player && attrID == AMSPlayerAttr_PlaybackInfo);
     bool stateChanged = false;
 
     if (isTimeUpdate) {
-        int comma = valueStr.indexOf(',');
         int newState = -1;
-        if(comma != -1) newState = valueStr.substring(0, comma).toInt();
-        else if (valueStr.length() > 0) newState = valueStr.toInt();
+        if (valueStr.length() > 0) newState = atoi(valueStr.c_str()); // stops at the first ','
         
         if (newState != _lastPlaybackState) {
             stateChanged = true;
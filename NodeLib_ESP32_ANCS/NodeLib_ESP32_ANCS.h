@@ -1,34 +1,46 @@
 #ifndef NODELIB_ESP32_ANCS_H
 #define NODELIB_ESP32_ANCS_H
 
-#include <Arduino.h>
-#include <BLEDevice.h>
-#include <BLEServer.h>
-#include <BLEUtils.h>
-#include <BLE2902.h>
-#include <BLEClient.h>
-#include <map> 
+#include "NodeLib_Port.h"
+#include "NodeLib_Transport.h"
+#include <string>
+#include <type_traits>
+
+#if defined(ARDUINO_ARCH_ESP32)
+#include "sdkconfig.h"
+#endif
 
 // Callback types
 typedef void (*NodeLibNotificationCallback)(int eventId, uint32_t uid, const char* appId, const char* title, const char* message);
 typedef void (*NodeLibMediaCallback)(const char* title, const char* artist, const char* album, bool isPlaying);
 
-class NodeLib_ESP32_ANCS {
+class NodeLib_ESP32_ANCS : public NodeLibTransportListener {
 public:
-    NodeLib_ESP32_ANCS();
+#if defined(CONFIG_BLUEDROID_ENABLED)
+    NodeLib_ESP32_ANCS(); // Default Bluedroid backend (NodeLib_Transport_Bluedroid.cpp)
+#else
+    // No Bluedroid in this build, so there is no default backend
+    template <typename T = void>
+    NodeLib_ESP32_ANCS() {
+        static_assert(!std::is_same<T, T>::value,
+            "Bluedroid is not enabled: pass a transport, e.g. NodeLib_ESP32_ANCS ancs(nimbleTransport);");
+    }
+#endif
+    explicit NodeLib_ESP32_ANCS(NodeLibTransport& transport);
     void begin(const char* deviceName = "NodeLib-ESP32");
     void loop();
     void setCallback(NodeLibNotificationCallback cb);
     void setMediaCallback(NodeLibMediaCallback cb);
     
-    // Internal callbacks
+    // Internal callbacks (NodeLibTransportListener)
+    void _handleConnect();
+    void _handleDisconnect();
+    void _onSecurityComplete(bool success);
+    void _onCharNotify(NodeLibChar chr, uint8_t* pData, size_t length);
+
     void _onAncsDataReceived(uint8_t* pData, size_t length);
     void _onAncsNotificationReceived(uint8_t* pData, size_t length);
     void _onAmsUpdateReceived(uint8_t* pData, size_t length);
-    
-    void _handleConnect(esp_ble_gatts_cb_param_t *param);
-    void _handleDisconnect();
-    void _onSecurityComplete(bool success);
 
 private:
     NodeLibNotificationCallback _cbNotify;
@@ -52,21 +64,9 @@ private:
     };
     ParseState _pState;
     
-    // BLE Objects
-    BLEServer* _pServer;
-    BLEClient* _pClient;
-    BLEAddress* _pRemoteAddress;
-    
-    // ANCS Characteristics
-    BLERemoteCharacteristic* _pRemoteNotif; 
-    BLERemoteCharacteristic* _pRemoteCP;    
-    BLERemoteCharacteristic* _pRemoteData;  
+    // BLE Backend
+    NodeLibTransport* _transport;
     bool _ancsAvailable;
-
-    // AMS Characteristics
-    BLERemoteCharacteristic* _pRemoteCmd;          
-    BLERemoteCharacteristic* _pRemoteEntityUpdate; 
-    BLERemoteCharacteristic* _pRemoteEntityAttr;   
     bool _amsAvailable;
 
     // ANCS Parsing Variables
@@ -75,18 +75,18 @@ private:
     uint16_t _attrLen;
     uint16_t _attrBytesRead;
     uint8_t _currentAttrId;
-    String _currentBuffer; 
+    std::string _currentBuffer; 
     bool _pendingRequest;
     uint32_t _targetUID;
     uint32_t _activeRequestUID;
-    String _tempAppId;     
-    String _tempTitle;     
-    String _tempMessage;   
+    std::string _tempAppId;     
+    std::string _tempTitle;     
+    std::string _tempMessage;   
 
     // AMS Storage
-    String _mediaTitle;    
-    String _mediaArtist;   
-    String _mediaAlbum;    
+    std::string _mediaTitle;    
+    std::string _mediaArtist;   
+    std::string _mediaAlbum;    
     bool _mediaPlaying;
     int _lastPlaybackState;
 
@@ -98,11 +98,6 @@ private:
     void setState(AppState newState);
     void performAncsRequest(uint32_t uid);
     void subscribeToAms();
-    void addSolicitation(BLEAdvertisementData &adv, BLEUUID uuid);
-    BLERemoteCharacteristic* findChar(BLERemoteService* pService, BLEUUID uuid);
-    BLERemoteService* findService(BLEUUID uuid); 
-    void dumpVisibleServices(); 
-    void dumpServiceCharacteristics(BLERemoteService* pService);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef NODELIB_PORT_H
+#define NODELIB_PORT_H
+
+// Minimal platform layer so the protocol core builds both on Arduino and on
+// a Linux host (together with NodeLib_Transport_Loopback).
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+#define NODELIB_LOG(...) Serial.printf(__VA_ARGS__)
+
+static inline unsigned long nodelib_millis() { return millis(); }
+static inline void nodelib_delay(unsigned long ms) { delay(ms); }
+
+#else
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define NODELIB_LOG(...) printf(__VA_ARGS__)
+
+// Virtual clock on the host: only nodelib_delay() and nodelib_set_millis()
+// move it, so tests step through the state-machine timeouts without sleeping.
+extern unsigned long nodelib_host_millis;
+
+static inline unsigned long nodelib_millis() { return nodelib_host_millis; }
+static inline void nodelib_delay(unsigned long ms) { nodelib_host_millis += ms; }
+static inline void nodelib_set_millis(unsigned long ms) { nodelib_host_millis = ms; }
+#endif
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef NODELIB_TRANSPORT_H
+#define NODELIB_TRANSPORT_H
+
+#include "NodeLib_Port.h"
+
+// Remote GATT services the core cares about
+enum NodeLibService {
+    NODELIB_SVC_ANCS,
+    NODELIB_SVC_AMS,
+    NODELIB_SVC_COUNT
+};
+
+// Remote GATT characteristics the core cares about
+enum NodeLibChar {
+    NODELIB_CHR_ANCS_NOTIF,
+    NODELIB_CHR_ANCS_CP,
+    NODELIB_CHR_ANCS_DATA,
+    NODELIB_CHR_AMS_REMOTE_CMD,
+    NODELIB_CHR_AMS_ENTITY_UPDATE,
+    NODELIB_CHR_AMS_ENTITY_ATTR,
+    NODELIB_CHR_COUNT
+};
+
+// --- UUID TABLES (indexed by the enums above) ---
+static const char* const NODELIB_SERVICE_UUID[NODELIB_SVC_COUNT] = {
+    "7905F431-B5CE-4E99-A40F-4B1E122D00D0", // ANCS
+    "89D3502B-0F36-433A-8EF4-C502AD55F8DC"  // AMS
+};
+
+static const char* const NODELIB_CHAR_UUID[NODELIB_CHR_COUNT] = {
+    "9FBF120D-6301-42D9-8C58-25E699A21DBD", // ANCS Notification Source
+    "69D1D8F3-45E1-49A8-9821-9BBDFDAAD9D9", // ANCS Control Point
+    "22EAC6E9-24D6-4BB5-BE44-B36ACE7C7FDB", // ANCS Data Source
+    "9B3C81D8-57B1-4A8A-B8DF-0E56F7CA51C2", // AMS Remote Command
+    "2F7CABCE-808D-411F-9A0C-BB92BA96C102", // AMS Entity Update
+    "C6B2F38C-23AB-46D8-A6AB-A3A870BBD5D7"  // AMS Entity Attribute
+};
+
+static const NodeLibService NODELIB_CHAR_SERVICE[NODELIB_CHR_COUNT] = {
+    NODELIB_SVC_ANCS, NODELIB_SVC_ANCS, NODELIB_SVC_ANCS,
+    NODELIB_SVC_AMS, NODELIB_SVC_AMS, NODELIB_SVC_AMS
+};
+
+// Fallback for non-standard or corrupted Data Source UUIDs seen in logs
+#define NODELIB_ANCS_DATA_UUID_ALT "22eac6e9-24d6-4bb5-be44-b36ace7c7bfb"
+
+// Events flowing from a transport back into the protocol core
+class NodeLibTransportListener {
+public:
+    virtual ~NodeLibTransportListener() {}
+    virtual void _handleConnect() = 0;
+    virtual void _handleDisconnect() = 0;
+    virtual void _onSecurityComplete(bool success) = 0;
+    virtual void _onCharNotify(NodeLibChar chr, uint8_t* pData, size_t length) = 0;
+};
+
+// BLE transport used by NodeLib_ESP32_ANCS. A backend owns the peripheral
+// role (advertising, pairing), the GATT client connection back to the phone
+// and the discovered characteristics; the core only sees NodeLibChar ids.
+class NodeLibTransport {
+public:
+    NodeLibTransport() : _listener(nullptr) {}
+    virtual ~NodeLibTransport() {}
+
+    void setListener(NodeLibTransportListener* listener) { _listener = listener; }
+
+    // Init the stack and start advertising
+    virtual void begin(const char* deviceName) = 0;
+    virtual void startAdvertising() = 0;
+
+    // Open the GATT client towards the connected phone and start encryption
+    virtual bool connectClient() = 0;
+    virtual bool isClientConnected() = 0;
+
+    // Resolve the service and its characteristics. Returns true if the service exists.
+    virtual bool discoverService(NodeLibService svc) = 0;
+    virtual bool hasChar(NodeLibChar chr) = 0;
+
+    // Enable notifications, delivered through NodeLibTransportListener::_onCharNotify
+    virtual bool subscribe(NodeLibChar chr) = 0;
+    virtual bool write(NodeLibChar chr, const uint8_t* pData, size_t length, bool withResponse) = 0;
+
+    // Debug helpers
+    virtual void dumpServices() {}
+    virtual void dumpCharacteristics(NodeLibService /*svc*/) {}
+
+protected:
+    NodeLibTransportListener* _listener;
+};
+
+#endif
@@ -0,0 +1,258 @@
+#if defined(ARDUINO_ARCH_ESP32)
+#include "sdkconfig.h"
+#endif
+
+#if defined(CONFIG_BLUEDROID_ENABLED)
+
+#include "NodeLib_Transport_Bluedroid.h"
+#include "NodeLib_ESP32_ANCS.h"
+#include "esp_gap_ble_api.h"
+
+NodeLibBluedroidTransport* globalBluedroidTransport = nullptr;
+
+// --- SECURITY CALLBACKS ---
+class NodeLibSecurityCallbacks : public BLESecurityCallbacks {
+  uint32_t onPassKeyRequest(){ return 0; }
+  void onPassKeyNotify(uint32_t pass_key){ Serial.printf(">> [PAIRING] PIN: %06d\n", pass_key); }
+  bool onConfirmPIN(uint32_t pass_key){ return true; }
+  bool onSecurityRequest(){ return true; }
+  void onAuthenticationComplete(esp_ble_auth_cmpl_t cmpl){
+    if(cmpl.success){
+        Serial.println(">> [PAIRING] Success!");
+    } else {
+        Serial.printf(">> [PAIRING] Fail: %d\n", cmpl.fail_reason);
+    }
+    if(globalBluedroidTransport) globalBluedroidTransport->_onSecurityComplete(cmpl.success);
+  }
+};
+
+// --- SERVER CALLBACKS ---
+class NodeLibServerCallbacks : public BLEServerCallbacks {
+  void onConnect(BLEServer* pServer, esp_ble_gatts_cb_param_t *param) {
+    if (globalBluedroidTransport) globalBluedroidTransport->_handleConnect(param);
+  }
+  void onDisconnect(BLEServer* pServer) {
+    if (globalBluedroidTransport) globalBluedroidTransport->_handleDisconnect();
+  }
+};
+
+// --- STATIC WRAPPERS ---
+static void staticOnNotify(BLERemoteCharacteristic* pChar, uint8_t* pData, size_t length, bool isNotify) {
+    if (globalBluedroidTransport) globalBluedroidTransport->_onNotify(pChar, pData, length);
+}
+
+// --- DEFAULT BACKEND ---
+
+// Lives here rather than in the core so that sketches passing their own
+// transport never link the Bluedroid stack.
+static NodeLibTransport& defaultBluedroidTransport() {
+    static NodeLibBluedroidTransport transport;
+    return transport;
+}
+
+NodeLib_ESP32_ANCS::NodeLib_ESP32_ANCS() : NodeLib_ESP32_ANCS(defaultBluedroidTransport()) {}
+
+// --- IMPLEMENTATION ---
+
+NodeLibBluedroidTransport::NodeLibBluedroidTransport() {
+    globalBluedroidTransport = this;
+    _pServer = nullptr;
+    _pClient = nullptr;
+    _pRemoteAddress = nullptr;
+    for (int i = 0; i < NODELIB_SVC_COUNT; i++) _services[i] = nullptr;
+    for (int i = 0; i < NODELIB_CHR_COUNT; i++) _chars[i] = nullptr;
+}
+
+void NodeLibBluedroidTransport::addSolicitation(BLEAdvertisementData &adv, BLEUUID uuid) {
+    uint8_t d[18];
+    d[0] = 17; d[1] = 0x15; // Len, Type
+
+    esp_bt_uuid_t *raw = uuid.getNative();
+    for(int i=0; i<16; i++) {
+        d[2+i] = raw->uuid.uuid128[15-i];
+    }
+    String s = "";
+    for(int i=0; i<18; i++) s += (char)d[i];
+    adv.addData(s);
+}
+
+void NodeLibBluedroidTransport::begin(const char* deviceName) {
+    BLEDevice::init(deviceName);
+    BLEDevice::setMTU(517);
+
+    BLEDevice::setEncryptionLevel(ESP_BLE_SEC_ENCRYPT_MITM);
+    BLEDevice::setSecurityCallbacks(new NodeLibSecurityCallbacks());
+
+    _pServer = BLEDevice::createServer();
+    _pServer->setCallbacks(new NodeLibServerCallbacks());
+
+    // Device Info & HID
+    _pServer->createService(BLEUUID("180A"))->start();
+    _pServer->createService(BLEUUID((uint16_t)0x1812))->start();
+
+    BLEAdvertising *pAdv = BLEDevice::getAdvertising();
+
+    BLEAdvertisementData oAdvData;
+    oAdvData.setFlags(0x06);
+    oAdvData.setName(deviceName);
+    oAdvData.setAppearance(0x00C2);
+    oAdvData.setCompleteServices(BLEUUID((uint16_t)0x1812));
+    pAdv->setAdvertisementData(oAdvData);
+
+    BLEAdvertisementData oScanData;
+    addSolicitation(oScanData, BLEUUID(NODELIB_SERVICE_UUID[NODELIB_SVC_ANCS]));
+    pAdv->setScanResponseData(oScanData);
+    pAdv->setScanResponse(true);
+
+    BLESecurity *pSec = new BLESecurity();
+    pSec->setAuthenticationMode(ESP_LE_AUTH_REQ_SC_MITM_BOND);
+    pSec->setCapability(ESP_IO_CAP_IO);
+    pSec->setInitEncryptionKey(ESP_BLE_ENC_KEY_MASK | ESP_BLE_ID_KEY_MASK);
+
+    BLEDevice::startAdvertising();
+}
+
+void NodeLibBluedroidTransport::startAdvertising() {
+    BLEDevice::startAdvertising();
+}
+
+void NodeLibBluedroidTransport::_handleConnect(esp_ble_gatts_cb_param_t *param) {
+    if (_pRemoteAddress) delete _pRemoteAddress;
+    _pRemoteAddress = new BLEAddress(param->connect.remote_bda);
+    Serial.printf(">> [CONN] %s\n", _pRemoteAddress->toString().c_str());
+    if (_listener) _listener->_handleConnect();
+}
+
+void NodeLibBluedroidTransport::_handleDisconnect() {
+    for (int i = 0; i < NODELIB_SVC_COUNT; i++) _services[i] = nullptr;
+    for (int i = 0; i < NODELIB_CHR_COUNT; i++) _chars[i] = nullptr;
+    if (_listener) _listener->_handleDisconnect();
+}
+
+void NodeLibBluedroidTransport::_onSecurityComplete(bool success) {
+    if (_listener) _listener->_onSecurityComplete(success);
+}
+
+void NodeLibBluedroidTransport::_onNotify(BLERemoteCharacteristic* pChar, uint8_t* pData, size_t length) {
+    if (!_listener) return;
+    for (int i = 0; i < NODELIB_CHR_COUNT; i++) {
+        if (_chars[i] == pChar) {
+            _listener->_onCharNotify((NodeLibChar)i, pData, length);
+            return;
+        }
+    }
+}
+
+bool NodeLibBluedroidTransport::connectClient() {
+    if (!_pClient) _pClient = BLEDevice::createClient();
+    if (_pClient->isConnected()) return true;
+    if (!_pRemoteAddress) return false;
+    if (!_pClient->connect(*_pRemoteAddress)) return false;
+
+    esp_bd_addr_t remoteAddr; memcpy(remoteAddr, _pRemoteAddress->getNative(), 6);
+    esp_ble_set_encryption(remoteAddr, ESP_BLE_SEC_ENCRYPT_MITM);
+    return true;
+}
+
+bool NodeLibBluedroidTransport::isClientConnected() {
+    return _pClient && _pClient->isConnected();
+}
+
+// FIX: Case-insensitive service lookup
+BLERemoteService* NodeLibBluedroidTransport::findService(BLEUUID uuid) {
+    BLERemoteService* pS = _pClient->getService(uuid);
+    if (pS) return pS;
+
+    std::map<std::string, BLERemoteService*>* pServices = _pClient->getServices();
+    if (!pServices) return nullptr;
+
+    for (auto const& [uuid_str, service] : *pServices) {
+        if (service->getUUID().equals(uuid)) {
+            return service;
+        }
+    }
+    return nullptr;
+}
+
+BLERemoteCharacteristic* NodeLibBluedroidTransport::findChar(BLERemoteService* pService, BLEUUID uuid) {
+    if (!pService) return nullptr;
+    BLERemoteCharacteristic* pChar = pService->getCharacteristic(uuid);
+    if (pChar) return pChar;
+    auto* m = pService->getCharacteristics();
+    if (!m) return nullptr;
+    for (auto& entry : *m) {
+        if (entry.second->getUUID().equals(uuid)) return entry.second;
+    }
+    return nullptr;
+}
+
+bool NodeLibBluedroidTransport::discoverService(NodeLibService svc) {
+    if (!_pClient) return false;
+    BLERemoteService* pService = findService(BLEUUID(NODELIB_SERVICE_UUID[svc]));
+    _services[svc] = pService;
+    if (!pService) return false;
+
+    for (int i = 0; i < NODELIB_CHR_COUNT; i++) {
+        if (NODELIB_CHAR_SERVICE[i] != svc) continue;
+        _chars[i] = findChar(pService, BLEUUID(NODELIB_CHAR_UUID[i]));
+    }
+
+    // Fallback for weird data UUID
+    if (svc == NODELIB_SVC_ANCS && !_chars[NODELIB_CHR_ANCS_DATA]) {
+        _chars[NODELIB_CHR_ANCS_DATA] = findChar(pService, BLEUUID(NODELIB_ANCS_DATA_UUID_ALT));
+        if (_chars[NODELIB_CHR_ANCS_DATA]) Serial.println(">> [ANCS] Found Data Source with ALT UUID.");
+    }
+    return true;
+}
+
+bool NodeLibBluedroidTransport::hasChar(NodeLibChar chr) {
+    return _chars[chr] != nullptr;
+}
+
+bool NodeLibBluedroidTransport::subscribe(NodeLibChar chr) {
+    BLERemoteCharacteristic* pChar = _chars[chr];
+    if (!pChar || !pChar->canNotify()) return false;
+    pChar->registerForNotify(staticOnNotify);
+    return true;
+}
+
+bool NodeLibBluedroidTransport::write(NodeLibChar chr, const uint8_t* pData, size_t length, bool withResponse) {
+    BLERemoteCharacteristic* pChar = _chars[chr];
+    if (!pChar) return false;
+    pChar->writeValue((uint8_t*)pData, length, withResponse);
+    return true;
+}
+
+void NodeLibBluedroidTransport::dumpServices() {
+    if(!_pClient) return;
+    std::map<std::string, BLERemoteService*>* pServices = _pClient->getServices();
+    if (pServices == nullptr) {
+        Serial.println(">> [DEBUG] getServices() returned null!");
+        return;
+    }
+
+    BLEUUID ancsUUID(NODELIB_SERVICE_UUID[NODELIB_SVC_ANCS]);
+    Serial.println(">> [DEBUG] --- Remote Service Dump ---");
+    for (auto const& [uuid_str, service] : *pServices) {
+        Serial.printf("   - UUID: %s\n", service->getUUID().toString().c_str());
+        if (service->getUUID().equals(ancsUUID)) Serial.println("     ^-- THIS IS ANCS!");
+    }
+    Serial.println(">> [DEBUG] ---------------------------");
+}
+
+void NodeLibBluedroidTransport::dumpCharacteristics(NodeLibService svc) {
+    BLERemoteService* pService = _services[svc];
+    if (!pService) return;
+    std::map<std::string, BLERemoteCharacteristic*>* pChars = pService->getCharacteristics();
+    if (!pChars) {
+        Serial.println(">> [DEBUG] Service has NO characteristics map.");
+        return;
+    }
+    Serial.printf(">> [DEBUG] Dump Chars for Service: %s\n", pService->getUUID().toString().c_str());
+    for (auto const& [uuid_str, pChar] : *pChars) {
+         Serial.printf("   - Char UUID: %s\n", pChar->getUUID().toString().c_str());
+    }
+    Serial.println(">> [DEBUG] ---------------------------");
+}
+
+#endif
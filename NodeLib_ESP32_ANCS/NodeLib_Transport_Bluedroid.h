@@ -0,0 +1,46 @@
+#ifndef NODELIB_TRANSPORT_BLUEDROID_H
+#define NODELIB_TRANSPORT_BLUEDROID_H
+
+#include "NodeLib_Transport.h"
+#include <BLEDevice.h>
+#include <BLEServer.h>
+#include <BLEUtils.h>
+#include <BLEClient.h>
+#include <map>
+
+// Backend on top of the Bluedroid-based Arduino BLE classes (the default).
+class NodeLibBluedroidTransport : public NodeLibTransport {
+public:
+    NodeLibBluedroidTransport();
+
+    void begin(const char* deviceName);
+    void startAdvertising();
+    bool connectClient();
+    bool isClientConnected();
+    bool discoverService(NodeLibService svc);
+    bool hasChar(NodeLibChar chr);
+    bool subscribe(NodeLibChar chr);
+    bool write(NodeLibChar chr, const uint8_t* pData, size_t length, bool withResponse);
+    void dumpServices();
+    void dumpCharacteristics(NodeLibService svc);
+
+    // Internal callbacks
+    void _handleConnect(esp_ble_gatts_cb_param_t *param);
+    void _handleDisconnect();
+    void _onSecurityComplete(bool success);
+    void _onNotify(BLERemoteCharacteristic* pChar, uint8_t* pData, size_t length);
+
+private:
+    BLEServer* _pServer;
+    BLEClient* _pClient;
+    BLEAddress* _pRemoteAddress;
+
+    BLERemoteService* _services[NODELIB_SVC_COUNT];
+    BLERemoteCharacteristic* _chars[NODELIB_CHR_COUNT];
+
+    void addSolicitation(BLEAdvertisementData &adv, BLEUUID uuid);
+    BLERemoteCharacteristic* findChar(BLERemoteService* pService, BLEUUID uuid);
+    BLERemoteService* findService(BLEUUID uuid);
+};
+
+#endif
@@ -0,0 +1,89 @@
+#include "NodeLib_Transport_Loopback.h"
+
+NodeLibLoopbackTransport::NodeLibLoopbackTransport() {
+    _advertising = false;
+    _peerConnected = false;
+    _clientConnected = false;
+    for (int i = 0; i < NODELIB_SVC_COUNT; i++) _servicePresent[i] = true;
+    for (int i = 0; i < NODELIB_CHR_COUNT; i++) {
+        _discovered[i] = false;
+        _subscribed[i] = false;
+    }
+}
+
+void NodeLibLoopbackTransport::begin(const char* /*deviceName*/) {
+    _advertising = true;
+}
+
+void NodeLibLoopbackTransport::startAdvertising() {
+    _advertising = true;
+}
+
+bool NodeLibLoopbackTransport::connectClient() {
+    if (!_peerConnected) return false;
+    _clientConnected = true;
+    return true;
+}
+
+bool NodeLibLoopbackTransport::isClientConnected() {
+    return _clientConnected;
+}
+
+bool NodeLibLoopbackTransport::discoverService(NodeLibService svc) {
+    if (!_clientConnected || !_servicePresent[svc]) return false;
+    for (int i = 0; i < NODELIB_CHR_COUNT; i++) {
+        if (NODELIB_CHAR_SERVICE[i] == svc) _discovered[i] = true;
+    }
+    return true;
+}
+
+bool NodeLibLoopbackTransport::hasChar(NodeLibChar chr) {
+    return _discovered[chr];
+}
+
+bool NodeLibLoopbackTransport::subscribe(NodeLibChar chr) {
+    if (!_discovered[chr]) return false;
+    _subscribed[chr] = true;
+    return true;
+}
+
+bool NodeLibLoopbackTransport::write(NodeLibChar chr, const uint8_t* pData, size_t length, bool /*withResponse*/) {
+    if (!_discovered[chr]) return false;
+    Write w;
+    w.chr = chr;
+    w.data.assign(pData, pData + length);
+    _writes.push_back(w);
+    return true;
+}
+
+void NodeLibLoopbackTransport::peerConnect() {
+    _advertising = false;
+    _peerConnected = true;
+    if (_listener) _listener->_handleConnect();
+}
+
+void NodeLibLoopbackTransport::peerDisconnect() {
+    _peerConnected = false;
+    _clientConnected = false;
+    for (int i = 0; i < NODELIB_CHR_COUNT; i++) {
+        _discovered[i] = false;
+        _subscribed[i] = false;
+    }
+    if (_listener) _listener->_handleDisconnect();
+}
+
+void NodeLibLoopbackTransport::peerSecure(bool success) {
+    if (_listener) _listener->_onSecurityComplete(success);
+}
+
+void NodeLibLoopbackTransport::peerSetService(NodeLibService svc, bool present) {
+    _servicePresent[svc] = present;
+}
+
+bool NodeLibLoopbackTransport::peerNotify(NodeLibChar chr, const uint8_t* pData, size_t length) {
+    if (!_subscribed[chr] || !_listener) return false;
+    // Listener takes a mutable buffer, like the BLE stacks hand out
+    std::vector<uint8_t> buf(pData, pData + length);
+    _listener->_onCharNotify(chr, buf.data(), buf.size());
+    return true;
+}
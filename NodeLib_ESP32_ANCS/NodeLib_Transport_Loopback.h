@@ -0,0 +1,58 @@
+#ifndef NODELIB_TRANSPORT_LOOPBACK_H
+#define NODELIB_TRANSPORT_LOOPBACK_H
+
+#include "NodeLib_Transport.h"
+#include <vector>
+
+// In-memory backend with no radio. The peer* methods play the phone's side,
+// so the state machine and the ANCS/AMS parsers can be driven on a Linux host.
+//
+// Usage:
+//   NodeLibLoopbackTransport phone;
+//   NodeLib_ESP32_ANCS ancs(phone);
+//   ancs.begin();
+//   phone.peerConnect(); phone.peerSecure(true);
+//   while (!phone.isSubscribed(NODELIB_CHR_ANCS_NOTIF)) ancs.loop();
+//   phone.peerNotify(NODELIB_CHR_ANCS_NOTIF, data, len);
+class NodeLibLoopbackTransport : public NodeLibTransport {
+public:
+    struct Write {
+        NodeLibChar chr;
+        std::vector<uint8_t> data;
+    };
+
+    NodeLibLoopbackTransport();
+
+    void begin(const char* deviceName);
+    void startAdvertising();
+    bool connectClient();
+    bool isClientConnected();
+    bool discoverService(NodeLibService svc);
+    bool hasChar(NodeLibChar chr);
+    bool subscribe(NodeLibChar chr);
+    bool write(NodeLibChar chr, const uint8_t* pData, size_t length, bool withResponse);
+
+    // Peer (phone) side
+    void peerConnect();
+    void peerDisconnect();
+    void peerSecure(bool success);
+    void peerSetService(NodeLibService svc, bool present);
+    bool peerNotify(NodeLibChar chr, const uint8_t* pData, size_t length);
+
+    // Inspection
+    bool isAdvertising() const { return _advertising; }
+    bool isSubscribed(NodeLibChar chr) const { return _subscribed[chr]; }
+    const std::vector<Write>& writes() const { return _writes; }
+    void clearWrites() { _writes.clear(); }
+
+private:
+    bool _advertising;
+    bool _peerConnected;
+    bool _clientConnected;
+    bool _servicePresent[NODELIB_SVC_COUNT];
+    bool _discovered[NODELIB_CHR_COUNT];
+    bool _subscribed[NODELIB_CHR_COUNT];
+    std::vector<Write> _writes;
+};
+
+#endif
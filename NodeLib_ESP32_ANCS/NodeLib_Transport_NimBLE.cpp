@@ -0,0 +1,189 @@
+// Only built when NimBLE-Arduino is installed and included by the sketch
+#if defined(__has_include)
+#if __has_include(<NimBLEDevice.h>)
+
+#include "NodeLib_Transport_NimBLE.h"
+
+NodeLibNimBLETransport* globalNimBLETransport = nullptr;
+
+// --- SERVER CALLBACKS (connection + pairing) ---
+class NodeLibNimBLEServerCallbacks : public NimBLEServerCallbacks {
+  void onConnect(NimBLEServer* /*pServer*/, NimBLEConnInfo& connInfo) {
+    if (globalNimBLETransport) globalNimBLETransport->_handleConnect(connInfo);
+  }
+  void onDisconnect(NimBLEServer* /*pServer*/, NimBLEConnInfo& /*connInfo*/, int /*reason*/) {
+    if (globalNimBLETransport) globalNimBLETransport->_handleDisconnect();
+  }
+  uint32_t onPassKeyDisplay() {
+    uint32_t pass_key = (uint32_t)random(1000000);
+    Serial.printf(">> [PAIRING] PIN: %06d\n", pass_key);
+    return pass_key;
+  }
+  void onConfirmPassKey(NimBLEConnInfo& connInfo, uint32_t pass_key) {
+    Serial.printf(">> [PAIRING] PIN: %06d\n", pass_key);
+    NimBLEDevice::injectConfirmPasskey(connInfo, true);
+  }
+  void onAuthenticationComplete(NimBLEConnInfo& connInfo) {
+    if (connInfo.isEncrypted()) {
+        Serial.println(">> [PAIRING] Success!");
+    } else {
+        Serial.println(">> [PAIRING] Fail");
+    }
+    if (globalNimBLETransport) globalNimBLETransport->_onSecurityComplete(connInfo.isEncrypted());
+  }
+};
+
+// --- IMPLEMENTATION ---
+
+NodeLibNimBLETransport::NodeLibNimBLETransport() {
+    globalNimBLETransport = this;
+    _pServer = nullptr;
+    _pClient = nullptr;
+    _connHandle = BLE_HS_CONN_HANDLE_NONE;
+    for (int i = 0; i < NODELIB_SVC_COUNT; i++) {
+        _services[i] = nullptr;
+        _discoveryTried[i] = false;
+    }
+    for (int i = 0; i < NODELIB_CHR_COUNT; i++) _chars[i] = nullptr;
+}
+
+void NodeLibNimBLETransport::begin(const char* deviceName) {
+    NimBLEDevice::init(deviceName);
+    NimBLEDevice::setMTU(517);
+
+    NimBLEDevice::setSecurityAuth(true, true, true); // Bond, MITM, SC
+    NimBLEDevice::setSecurityIOCap(BLE_HS_IO_DISPLAY_YESNO);
+    NimBLEDevice::setSecurityInitKey(BLE_SM_PAIR_KEY_DIST_ENC | BLE_SM_PAIR_KEY_DIST_ID);
+    NimBLEDevice::setSecurityRespKey(BLE_SM_PAIR_KEY_DIST_ENC | BLE_SM_PAIR_KEY_DIST_ID);
+
+    _pServer = NimBLEDevice::createServer();
+    _pServer->setCallbacks(new NodeLibNimBLEServerCallbacks());
+
+    // Device Info & HID
+    _pServer->createService(NimBLEUUID((uint16_t)0x180A))->start();
+    _pServer->createService(NimBLEUUID((uint16_t)0x1812))->start();
+    _pServer->start();
+
+    NimBLEAdvertising *pAdv = NimBLEDevice::getAdvertising();
+
+    NimBLEAdvertisementData oAdvData;
+    oAdvData.setFlags(0x06);
+    oAdvData.setName(deviceName);
+    oAdvData.setAppearance(0x00C2);
+    oAdvData.setCompleteServices(NimBLEUUID((uint16_t)0x1812));
+    pAdv->setAdvertisementData(oAdvData);
+
+    // ANCS solicitation, same byte layout as the Bluedroid backend
+    NimBLEUUID ancsUUID(NODELIB_SERVICE_UUID[NODELIB_SVC_ANCS]);
+    const uint8_t* raw = ancsUUID.to128().getValue(); // little-endian
+    uint8_t d[18];
+    d[0] = 17; d[1] = 0x15; // Len, Type
+    for(int i=0; i<16; i++) {
+        d[2+i] = raw[15-i];
+    }
+    NimBLEAdvertisementData oScanData;
+    oScanData.addData(d, sizeof(d));
+    pAdv->setScanResponseData(oScanData);
+    pAdv->enableScanResponse(true);
+
+    NimBLEDevice::startAdvertising();
+}
+
+void NodeLibNimBLETransport::startAdvertising() {
+    NimBLEDevice::startAdvertising();
+}
+
+void NodeLibNimBLETransport::_handleConnect(NimBLEConnInfo& connInfo) {
+    _connHandle = connInfo.getConnHandle();
+    Serial.printf(">> [CONN] %s\n", connInfo.getAddress().toString().c_str());
+    if (_listener) _listener->_handleConnect();
+}
+
+void NodeLibNimBLETransport::_handleDisconnect() {
+    _connHandle = BLE_HS_CONN_HANDLE_NONE;
+    _pClient = nullptr; // Owned by the server
+    for (int i = 0; i < NODELIB_SVC_COUNT; i++) {
+        _services[i] = nullptr;
+        _discoveryTried[i] = false;
+    }
+    for (int i = 0; i < NODELIB_CHR_COUNT; i++) _chars[i] = nullptr;
+    if (_listener) _listener->_handleDisconnect();
+}
+
+void NodeLibNimBLETransport::_onSecurityComplete(bool success) {
+    if (_listener) _listener->_onSecurityComplete(success);
+}
+
+bool NodeLibNimBLETransport::connectClient() {
+    if (_connHandle == BLE_HS_CONN_HANDLE_NONE) return false;
+
+    // No second connection: run the GATT client over the phone's link
+    if (!_pClient) _pClient = _pServer->getClient(_connHandle);
+    if (!_pClient) return false;
+
+    NimBLEDevice::startSecurity(_connHandle);
+    return true;
+}
+
+bool NodeLibNimBLETransport::isClientConnected() {
+    return _pClient && _pClient->isConnected();
+}
+
+bool NodeLibNimBLETransport::discoverService(NodeLibService svc) {
+    if (!_pClient) return false;
+
+    // Retried lookups are rate-limited; reuse the last result in between
+    if (_discoveryTried[svc] && millis() - _lastDiscovery[svc] < NODELIB_NIMBLE_DISCOVERY_RETRY_MS) {
+        return _services[svc] != nullptr;
+    }
+    _discoveryTried[svc] = true;
+    _lastDiscovery[svc] = millis();
+
+    // Discovers only this service (by UUID), not the full remote database
+    NimBLERemoteService* pService = _pClient->getService(NimBLEUUID(NODELIB_SERVICE_UUID[svc]));
+    _services[svc] = pService;
+    if (!pService) return false;
+
+    for (int i = 0; i < NODELIB_CHR_COUNT; i++) {
+        if (NODELIB_CHAR_SERVICE[i] != svc) continue;
+        _chars[i] = pService->getCharacteristic(NimBLEUUID(NODELIB_CHAR_UUID[i]));
+    }
+
+    // Fallback for weird data UUID
+    if (svc == NODELIB_SVC_ANCS && !_chars[NODELIB_CHR_ANCS_DATA]) {
+        _chars[NODELIB_CHR_ANCS_DATA] = pService->getCharacteristic(NimBLEUUID(NODELIB_ANCS_DATA_UUID_ALT));
+        if (_chars[NODELIB_CHR_ANCS_DATA]) Serial.println(">> [ANCS] Found Data Source with ALT UUID.");
+    }
+    return true;
+}
+
+bool NodeLibNimBLETransport::hasChar(NodeLibChar chr) {
+    return _chars[chr] != nullptr;
+}
+
+bool NodeLibNimBLETransport::subscribe(NodeLibChar chr) {
+    NimBLERemoteCharacteristic* pChar = _chars[chr];
+    if (!pChar || !pChar->canNotify()) return false;
+    return pChar->subscribe(true, [this, chr](NimBLERemoteCharacteristic*, uint8_t* pData, size_t length, bool) {
+        if (_listener) _listener->_onCharNotify(chr, pData, length);
+    });
+}
+
+bool NodeLibNimBLETransport::write(NodeLibChar chr, const uint8_t* pData, size_t length, bool withResponse) {
+    NimBLERemoteCharacteristic* pChar = _chars[chr];
+    if (!pChar) return false;
+    return pChar->writeValue(pData, length, withResponse);
+}
+
+void NodeLibNimBLETransport::dumpCharacteristics(NodeLibService svc) {
+    NimBLERemoteService* pService = _services[svc];
+    if (!pService) return;
+    Serial.printf(">> [DEBUG] Dump Chars for Service: %s\n", pService->getUUID().toString().c_str());
+    for (auto pChar : pService->getCharacteristics(true)) {
+         Serial.printf("   - Char UUID: %s\n", pChar->getUUID().toString().c_str());
+    }
+    Serial.println(">> [DEBUG] ---------------------------");
+}
+
+#endif
+#endif
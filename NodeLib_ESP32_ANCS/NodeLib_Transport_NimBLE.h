@@ -0,0 +1,50 @@
+#ifndef NODELIB_TRANSPORT_NIMBLE_H
+#define NODELIB_TRANSPORT_NIMBLE_H
+
+#include "NodeLib_Transport.h"
+#include <NimBLEDevice.h>
+
+// A missed service lookup is a blocking GATT discovery; don't repeat it on every loop()
+#ifndef NODELIB_NIMBLE_DISCOVERY_RETRY_MS
+#define NODELIB_NIMBLE_DISCOVERY_RETRY_MS 1000
+#endif
+
+// Backend on top of NimBLE-Arduino (2.x). Uses far less RAM than Bluedroid,
+// reuses the phone's existing connection for the GATT client and only
+// discovers the ANCS/AMS services instead of the whole remote database.
+//
+// Usage:
+//   #include <NodeLib_Transport_NimBLE.h>
+//   NodeLibNimBLETransport transport;
+//   NodeLib_ESP32_ANCS ancs(transport);
+class NodeLibNimBLETransport : public NodeLibTransport {
+public:
+    NodeLibNimBLETransport();
+
+    void begin(const char* deviceName);
+    void startAdvertising();
+    bool connectClient();
+    bool isClientConnected();
+    bool discoverService(NodeLibService svc);
+    bool hasChar(NodeLibChar chr);
+    bool subscribe(NodeLibChar chr);
+    bool write(NodeLibChar chr, const uint8_t* pData, size_t length, bool withResponse);
+    void dumpCharacteristics(NodeLibService svc);
+
+    // Internal callbacks
+    void _handleConnect(NimBLEConnInfo& connInfo);
+    void _handleDisconnect();
+    void _onSecurityComplete(bool success);
+
+private:
+    NimBLEServer* _pServer;
+    NimBLEClient* _pClient;
+    uint16_t _connHandle;
+
+    NimBLERemoteService* _services[NODELIB_SVC_COUNT];
+    bool _discoveryTried[NODELIB_SVC_COUNT];
+    unsigned long _lastDiscovery[NODELIB_SVC_COUNT];
+    NimBLERemoteCharacteristic* _chars[NODELIB_CHR_COUNT];
+};
+
+#endif
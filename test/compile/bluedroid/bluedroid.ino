@@ -0,0 +1,12 @@
+// Compile-only sketch: default constructor -> Bluedroid backend
+#include <NodeLib_ESP32_ANCS.h>
+
+NodeLib_ESP32_ANCS ancs;
+
+void setup() {
+    ancs.begin("NodeLib-CI");
+}
+
+void loop() {
+    ancs.loop();
+}
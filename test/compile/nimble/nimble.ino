@@ -0,0 +1,14 @@
+// Compile-only sketch: NimBLE-Arduino 2.x backend
+#include <NodeLib_ESP32_ANCS.h>
+#include <NodeLib_Transport_NimBLE.h>
+
+NodeLibNimBLETransport transport;
+NodeLib_ESP32_ANCS ancs(transport);
+
+void setup() {
+    ancs.begin("NodeLib-CI");
+}
+
+void loop() {
+    ancs.loop();
+}
@@ -0,0 +1,202 @@
+// Host test: drives NodeLib_ESP32_ANCS through NodeLibLoopbackTransport.
+// Build and run with `make -C test`.
+
+#include "NodeLib_ESP32_ANCS.h"
+#include "NodeLib_Transport_Loopback.h"
+#include <algorithm>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } \
+} while (0)
+
+// --- CALLBACK CAPTURE ---
+static int notifyCount;
+static uint32_t lastUid;
+static std::string lastAppId, lastTitle, lastMessage;
+
+static int mediaCount;
+static std::string lastMediaTitle, lastMediaArtist, lastMediaAlbum;
+static bool lastPlaying;
+
+static void onNotify(int /*eventId*/, uint32_t uid, const char* appId, const char* title, const char* message) {
+    notifyCount++;
+    lastUid = uid;
+    lastAppId = appId; lastTitle = title; lastMessage = message;
+}
+
+static void onMedia(const char* title, const char* artist, const char* album, bool isPlaying) {
+    mediaCount++;
+    lastMediaTitle = title; lastMediaArtist = artist; lastMediaAlbum = album;
+    lastPlaying = isPlaying;
+}
+
+static void reset() {
+    nodelib_set_millis(0);
+    notifyCount = 0; lastUid = 0;
+    lastAppId = lastTitle = lastMessage = "";
+    mediaCount = 0; lastPlaying = false;
+    lastMediaTitle = lastMediaArtist = lastMediaAlbum = "";
+}
+
+// Run loop() until the core subscribed to chr or the virtual clock passes limitMs
+static bool runUntilSubscribed(NodeLib_ESP32_ANCS& ancs, NodeLibLoopbackTransport& phone, NodeLibChar chr, unsigned long limitMs) {
+    while (!phone.isSubscribed(chr)) {
+        if (nodelib_millis() > limitMs) return false;
+        ancs.loop();
+    }
+    return true;
+}
+
+static bool bytesEqual(const std::vector<uint8_t>& a, const uint8_t* b, size_t length) {
+    return a.size() == length && std::equal(a.begin(), a.end(), b);
+}
+
+// --- TESTS ---
+
+static void testAncsAndAms() {
+    reset();
+    NodeLibLoopbackTransport phone;
+    NodeLib_ESP32_ANCS ancs(phone);
+    ancs.setCallback(onNotify);
+    ancs.setMediaCallback(onMedia);
+
+    ancs.begin("test");
+    CHECK(phone.isAdvertising());
+
+    phone.peerConnect();
+    phone.peerSecure(true);
+    CHECK(!phone.isAdvertising());
+    CHECK(runUntilSubscribed(ancs, phone, NODELIB_CHR_ANCS_NOTIF, 5000));
+    CHECK(phone.isSubscribed(NODELIB_CHR_ANCS_DATA));
+    CHECK(phone.isSubscribed(NODELIB_CHR_AMS_ENTITY_UPDATE));
+
+    // AMS registration: player playback info, then track artist/album/title
+    const uint8_t cmdPlayer[] = { 0, 1 };
+    const uint8_t cmdTrack[] = { 2, 0, 2, 1, 2, 2 };
+    CHECK(phone.writes().size() == 2);
+    if (phone.writes().size() == 2) {
+        CHECK(phone.writes()[0].chr == NODELIB_CHR_AMS_ENTITY_UPDATE);
+        CHECK(bytesEqual(phone.writes()[0].data, cmdPlayer, sizeof(cmdPlayer)));
+        CHECK(phone.writes()[1].chr == NODELIB_CHR_AMS_ENTITY_UPDATE);
+        CHECK(bytesEqual(phone.writes()[1].data, cmdTrack, sizeof(cmdTrack)));
+    }
+    phone.clearWrites();
+
+    // Notification added (UID 0x01020304) -> Get Notification Attributes on the Control Point
+    const uint8_t added[] = { 0, 0, 1, 1, 0x04, 0x03, 0x02, 0x01 };
+    CHECK(phone.peerNotify(NODELIB_CHR_ANCS_NOTIF, added, sizeof(added)));
+    ancs.loop();
+    const uint8_t request[] = { 0, 0x04, 0x03, 0x02, 0x01, 0, 255, 0, 1, 255, 0, 3, 255, 0 };
+    CHECK(phone.writes().size() == 1);
+    if (phone.writes().size() == 1) {
+        CHECK(phone.writes()[0].chr == NODELIB_CHR_ANCS_CP);
+        CHECK(bytesEqual(phone.writes()[0].data, request, sizeof(request)));
+    }
+
+    // Data Source response, split across two notifications
+    const uint8_t part1[] = { 0, 0x04, 0x03, 0x02, 0x01,
+                              0, 9, 0, 'c', 'o', 'm', '.', 'a', 'p', 'p', 'l', 'e',
+                              1, 2, 0, 'H' };
+    const uint8_t part2[] = { 'i',
+                              3, 5, 0, 'h', 'e', 'l', 'l', 'o' };
+    phone.peerNotify(NODELIB_CHR_ANCS_DATA, part1, sizeof(part1));
+    CHECK(notifyCount == 0);
+    phone.peerNotify(NODELIB_CHR_ANCS_DATA, part2, sizeof(part2));
+    CHECK(notifyCount == 1);
+    CHECK(lastUid == 0x01020304);
+    CHECK(lastAppId == "com.apple");
+    CHECK(lastTitle == "Hi");
+    CHECK(lastMessage == "hello");
+
+    // AMS: track title, then playback state "playing"
+    const uint8_t title[] = { 2, 2, 0, 'S', 'o', 'n', 'g' };
+    phone.peerNotify(NODELIB_CHR_AMS_ENTITY_UPDATE, title, sizeof(title));
+    CHECK(mediaCount == 1);
+    CHECK(lastMediaTitle == "Song");
+    CHECK(lastMediaArtist == "Unknown");
+    CHECK(!lastPlaying);
+
+    const uint8_t playing[] = { 0, 1, 0, '1', ',', '1', '.', '0', ',', '5', '.', '0' };
+    phone.peerNotify(NODELIB_CHR_AMS_ENTITY_UPDATE, playing, sizeof(playing));
+    CHECK(mediaCount == 2);
+    CHECK(lastPlaying);
+
+    // Same playback state again is not reported
+    phone.peerNotify(NODELIB_CHR_AMS_ENTITY_UPDATE, playing, sizeof(playing));
+    CHECK(mediaCount == 2);
+
+    // Disconnect -> advertising again, subscriptions dropped
+    phone.peerDisconnect();
+    CHECK(phone.isAdvertising());
+    CHECK(!phone.isSubscribed(NODELIB_CHR_ANCS_NOTIF));
+}
+
+static void testRemovedEventIsIgnored() {
+    reset();
+    NodeLibLoopbackTransport phone;
+    NodeLib_ESP32_ANCS ancs(phone);
+    ancs.setCallback(onNotify);
+
+    ancs.begin("test");
+    phone.peerConnect();
+    phone.peerSecure(true);
+    CHECK(runUntilSubscribed(ancs, phone, NODELIB_CHR_ANCS_NOTIF, 5000));
+    phone.clearWrites();
+
+    const uint8_t removed[] = { 2, 0, 1, 1, 7, 0, 0, 0 };
+    phone.peerNotify(NODELIB_CHR_ANCS_NOTIF, removed, sizeof(removed));
+    ancs.loop();
+    CHECK(phone.writes().empty());
+}
+
+static void testAmsOnlyAfterTimeout() {
+    reset();
+    NodeLibLoopbackTransport phone;
+    NodeLib_ESP32_ANCS ancs(phone);
+    phone.peerSetService(NODELIB_SVC_ANCS, false);
+
+    ancs.begin("test");
+    phone.peerConnect();
+    phone.peerSecure(true);
+
+    // Waits for ANCS for 8 s before continuing with AMS alone
+    CHECK(runUntilSubscribed(ancs, phone, NODELIB_CHR_AMS_ENTITY_UPDATE, 20000));
+    CHECK(nodelib_millis() > 8000);
+    CHECK(!phone.isSubscribed(NODELIB_CHR_ANCS_NOTIF));
+}
+
+static void testNoServicesReadvertises() {
+    reset();
+    NodeLibLoopbackTransport phone;
+    NodeLib_ESP32_ANCS ancs(phone);
+    phone.peerSetService(NODELIB_SVC_ANCS, false);
+    phone.peerSetService(NODELIB_SVC_AMS, false);
+
+    ancs.begin("test");
+    phone.peerConnect();
+    phone.peerSecure(true);
+
+    // Gives up after 15 s of discovery and advertises again
+    while (!phone.isAdvertising() && nodelib_millis() < 30000) ancs.loop();
+    CHECK(phone.isAdvertising());
+    CHECK(nodelib_millis() > 15000);
+}
+
+int main() {
+    testAncsAndAms();
+    testRemovedEventIsIgnored();
+    testAmsOnlyAfterTimeout();
+    testNoServicesReadvertises();
+
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("All tests passed\n");
+    return 0;
+}